@@ -0,0 +1,43 @@
+# Converts files into byte arrays so they can be compiled straight into the executable.
+#
+# Usage: cmake -DOUTPUT_DIR=<directory> -DASSETS=<name>=<path>|<name>=<path>... -P embedAssets.cmake
+#
+# Writes embeddedAssets.h declaring "extern const unsigned char <name>[]" and "extern const unsigned int <name>Size"
+# for every asset, and <name>.cpp defining them. Each asset has its own source file so a static library built
+# from them only links the assets an executable actually uses.
+# A null terminator is appended (and left out of <name>Size) so text assets can be used as C strings.
+
+# Only touches a file when its contents change to avoid needless recompilation.
+function(writeIfDifferent path contents)
+  file(WRITE "${path}.tmp" "${contents}")
+  file(COPY_FILE "${path}.tmp" "${path}" ONLY_IF_DIFFERENT)
+  file(REMOVE "${path}.tmp")
+endfunction()
+
+string(REPLACE "|" ";" assetList "${ASSETS}")
+
+set(generatedComment "// Generated at build time by cmake/embedAssets.cmake. Do not edit.\n")
+set(headerContents "${generatedComment}#ifndef EMBEDDED_ASSETS_H\n#define EMBEDDED_ASSETS_H\n")
+
+foreach(asset IN LISTS assetList)
+  string(FIND "${asset}" "=" separatorIndex)
+  string(SUBSTRING "${asset}" 0 ${separatorIndex} assetName)
+  math(EXPR pathIndex "${separatorIndex} + 1")
+  string(SUBSTRING "${asset}" ${pathIndex} -1 assetPath)
+
+  file(READ "${assetPath}" assetBytes HEX)
+  string(LENGTH "${assetBytes}" hexLength)
+  math(EXPR assetSize "${hexLength} / 2")
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," assetBytes "${assetBytes}")
+
+  string(APPEND headerContents "\nextern const unsigned char ${assetName}[];\n")
+  string(APPEND headerContents "extern const unsigned int ${assetName}Size;\n")
+
+  set(sourceContents "${generatedComment}#include \"embeddedAssets.h\"\n")
+  string(APPEND sourceContents "\nconst unsigned char ${assetName}[] = {${assetBytes}0x00};\n")
+  string(APPEND sourceContents "const unsigned int ${assetName}Size = ${assetSize};\n")
+  writeIfDifferent("${OUTPUT_DIR}/${assetName}.cpp" "${sourceContents}")
+endforeach()
+
+string(APPEND headerContents "\n#endif\n")
+writeIfDifferent("${OUTPUT_DIR}/embeddedAssets.h" "${headerContents}")
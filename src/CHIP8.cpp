@@ -1,6 +1,9 @@
 #include <iostream>
 #include <fstream>
 #include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include "CHIP8.h"
 
 // Characters are 4x5, each byte represents a horizontal piece of it's respective character.
@@ -23,6 +26,52 @@ const unsigned char CHIP8FontSet[fontSetSize] = {
   0xF0, 0x80, 0xF0, 0x80, 0x80  // F
 };
 
+// SUPER-CHIP's 8x10 characters used by Fx30, stored in memory directly after the small font. XO-CHIP adds A - F.
+const unsigned char CHIP8BigFontSet[bigFontSetSize] = {
+  0xFF, 0xFF, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, // 0
+  0x18, 0x78, 0x78, 0x18, 0x18, 0x18, 0x18, 0x18, 0xFF, 0xFF, // 1
+  0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // 2
+  0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 3
+  0xC3, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0x03, 0x03, // 4
+  0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 5
+  0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, // 6
+  0xFF, 0xFF, 0x03, 0x03, 0x06, 0x0C, 0x18, 0x18, 0x18, 0x18, // 7
+  0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, // 8
+  0xFF, 0xFF, 0xC3, 0xC3, 0xFF, 0xFF, 0x03, 0x03, 0xFF, 0xFF, // 9
+  0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, // A
+  0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, // B
+  0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, // C
+  0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC, // D
+  0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // E
+  0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0  // F
+};
+
+static_assert(screenWordsPerRow == 2, "Row shifting below assumes rows are made of 2 words.");
+
+// Shifts a display row towards the right edge, bits leaving the first word move into the second.
+void shiftRowRight(uint64_t* row, int pixels) {
+  if(pixels >= 64) {
+    row[1] = row[0] >> (pixels - 64);
+    row[0] = 0;
+  }
+  else if(pixels > 0) {
+    row[1] = (row[1] >> pixels) | (row[0] << (64 - pixels));
+    row[0] >>= pixels;
+  }
+}
+
+// Shifts a display row towards the left edge, bits leaving the second word move into the first.
+void shiftRowLeft(uint64_t* row, int pixels) {
+  if(pixels >= 64) {
+    row[0] = row[1] << (pixels - 64);
+    row[1] = 0;
+  }
+  else if(pixels > 0) {
+    row[0] = (row[0] << pixels) | (row[1] >> (64 - pixels));
+    row[1] <<= pixels;
+  }
+}
+
 std::default_random_engine randGenerator;
 std::uniform_int_distribution<int> randDistribution(0, 255);
 
@@ -36,26 +85,51 @@ unsigned short CHIP8::getLastExecutedOpcode() {
   }
 }
 
+unsigned char CHIP8::getRegisterValue(int registerIndex) {
+  return V[registerIndex];
+}
+
 void CHIP8::registerValueOverride(int registerIndex, int registerValue) {
   V[registerIndex] = (unsigned char)registerValue;
 }
 
+bool CHIP8::getPixel(int plane, int x, int y) {
+  return (displayPlanes[plane][y][x / 64] >> (63 - x % 64)) & 0x01;
+}
+
+// Pixels only in the first plane are drawn as '@', only in the second as 'O', and in both as '#'.
 void CHIP8::outputScreenToConsole() {
-  for(int i = 0; i < screenHeight; i++) {
-    for(int j = 0; j < screenWidth; j++) {
-      if(graphicOutput[j + i*screenWidth] == 1) {
-        std::cout << "@";
-      }
-      else {
-        std::cout << " ";
-      }
+  const char pixelCharacters[] = {' ', '@', 'O', '#'};
+  std::string output;
+  output.reserve((displayWidth + 1) * (displayHeight + 1));
+
+  for(int i = 0; i < displayHeight; i++) {
+    for(int j = 0; j < displayWidth; j++) {
+      output += pixelCharacters[getPixel(0, j, i) | (getPixel(1, j, i) << 1)];
     }
-    std::cout << std::endl;
+    output += '\n';
   }
-  std::cout << "________________________________________________________________" << std::endl;
+  output.append(displayWidth, '_');
+  output += '\n';
+
+  std::cout << output << std::flush;
 }
 
-void CHIP8::initialization() {
+Variant parseVariant(const std::string& variantName) {
+  if(variantName == "SUPER-CHIP") {
+    return Variant::SUPER_CHIP;
+  }
+  if(variantName == "XO-CHIP") {
+    return Variant::XO_CHIP;
+  }
+
+  if(variantName != "CHIP-8") {
+    std::cout << "Unknown variant " << variantName << ", using CHIP-8." << std::endl;
+  }
+  return Variant::CHIP_8;
+}
+
+void CHIP8::initialization(Variant selectedVariant) {
   pc = 0x200; // 0x000 to 0x1FF is reserved for the interpretor.
   currentOpcode = 0;
   I = 0;
@@ -63,41 +137,183 @@ void CHIP8::initialization() {
   delayTimer = 0;
   soundTimer = 0;
 
-  std::fill_n(graphicOutput, screenPixelCount, 0);
+  variant = selectedVariant;
+  memorySize = (variant == Variant::XO_CHIP) ? extendedRAMSize : RAMSize;
+  quirkResetsFlag = (variant == Variant::CHIP_8);
+  quirkIncrementsIndex = (variant != Variant::SUPER_CHIP);
+  quirkWrapsSprites = (variant == Variant::XO_CHIP);
+  quirkShiftsVx = (variant == Variant::SUPER_CHIP);
+  quirkJumpsWithVx = (variant == Variant::SUPER_CHIP);
+
+  selectedPlanes = 0x01;
+  audioPitch = 64;
+  setResolution(false);
+
   std::fill_n(stack, 16, 0);
   std::fill_n(V, 16, 0);
-  std::fill_n(RAM, RAMSize, 0);
+  std::fill_n(flagRegisters, 16, 0);
+  std::fill_n(audioPattern, 16, 0);
+  std::fill_n(RAM, extendedRAMSize, 0);
 
   for(int i = 0; i < fontSetSize; i++) {
     RAM[i] = CHIP8FontSet[i];
   }
+
+  for(int i = 0; i < bigFontSetSize; i++) {
+    RAM[fontSetSize + i] = CHIP8BigFontSet[i];
+  }
 }
 
 int CHIP8::loadProgram(std::string fileName) {
   // Open ROM file.
   std::fstream fout;
-  fout.open("ROMs\\" + fileName, std::ios::in | std::ios::binary);
+  fout.open("ROMs/" + fileName, std::ios::in | std::ios::binary);
   if(!fout) {
     return -1;
   }
 
-  // Read ROM.
-  char ROM[RAMSize - interpretorSize];
-  std::fill_n(ROM, RAMSize - interpretorSize, 0);
-  fout.read(ROM, sizeof(ROM));
+  // Read ROM directly into memory.
+  fout.read((char*)RAM + interpretorSize, memorySize - interpretorSize);
   fout.close();
 
-  // Write ROM into memory.
-  for(int i = 0; i < sizeof(ROM)/sizeof(char); i++) {
-    RAM[interpretorSize + i] = ROM[i];
+  return 0;
+}
+
+// XO-CHIP's F000 nnnn is 4 bytes long, so skipping over it has to move past both halves.
+void CHIP8::skipNextInstruction() {
+  unsigned short nextOpcode = (RAM[(unsigned short)(pc + 2)] << 8) | RAM[(unsigned short)(pc + 3)];
+  if(variant == Variant::XO_CHIP && nextOpcode == 0xF000) {
+    pc += 4;
   }
+  else {
+    pc += 2;
+  }
+}
 
-  return 0;
+// Switching resolution also clears the display on all planes.
+void CHIP8::setResolution(bool highResolution) {
+  displayWidth = highResolution ? highResScreenWidth : lowResScreenWidth;
+  displayHeight = highResolution ? highResScreenHeight : lowResScreenHeight;
+  std::memset(displayPlanes, 0, sizeof(displayPlanes));
+}
+
+void CHIP8::clearSelectedPlanes() {
+  for(int plane = 0; plane < screenPlaneCount; plane++) {
+    if(selectedPlanes & (1 << plane)) {
+      std::memset(displayPlanes[plane], 0, sizeof(displayPlanes[plane]));
+    }
+  }
+}
+
+// Positive values scroll down and negative values scroll up. Whole rows are moved at once.
+void CHIP8::scrollVertically(int rows) {
+  const int rowSize = sizeof(displayPlanes[0][0]);
+  const int distance = std::min(std::abs(rows), displayHeight);
+
+  for(int plane = 0; plane < screenPlaneCount; plane++) {
+    if(!(selectedPlanes & (1 << plane))) {
+      continue;
+    }
+
+    if(rows > 0) {
+      std::memmove(displayPlanes[plane][distance], displayPlanes[plane][0], (displayHeight - distance) * rowSize);
+      std::memset(displayPlanes[plane][0], 0, distance * rowSize);
+    }
+    else {
+      std::memmove(displayPlanes[plane][0], displayPlanes[plane][distance], (displayHeight - distance) * rowSize);
+      std::memset(displayPlanes[plane][displayHeight - distance], 0, distance * rowSize);
+    }
+  }
+}
+
+// Positive values scroll right and negative values scroll left. Each row is shifted as a pair of words.
+void CHIP8::scrollHorizontally(int pixels) {
+  for(int plane = 0; plane < screenPlaneCount; plane++) {
+    if(!(selectedPlanes & (1 << plane))) {
+      continue;
+    }
+
+    for(int i = 0; i < displayHeight; i++) {
+      uint64_t* row = displayPlanes[plane][i];
+      if(pixels > 0) {
+        shiftRowRight(row, pixels);
+      }
+      else {
+        shiftRowLeft(row, -pixels);
+      }
+
+      // Bits pushed past the right edge in low resolution mode land in the unused second word.
+      if(displayWidth == lowResScreenWidth) {
+        row[1] = 0;
+      }
+    }
+  }
+}
+
+/* Draws a sprite from memory at I to every selected plane, XO-CHIP stores the data for each plane
+ * back to back. A height of 0 draws a 16x16 sprite on SUPER-CHIP and XO-CHIP. Each sprite row is
+ * turned into a mask covering a full display row so it can be XORed in with one operation per word.
+ */
+void CHIP8::drawSprite(int x, int y, int height) {
+  const bool largeSprite = (height == 0 && variant != Variant::CHIP_8);
+  const int spriteWidth = largeSprite ? 16 : 8;
+  const int spriteHeight = largeSprite ? 16 : height;
+  const int bytesPerRow = spriteWidth / 8;
+
+  // Carry flag set to 0 by default, 1 if a pixel is erased when drawing.
+  V[15] = 0x00;
+
+  // The starting position always wraps, the rest of the sprite is clipped at the screen edges unless the variant wraps sprites.
+  x %= displayWidth;
+  y %= displayHeight;
+
+  unsigned short spriteAddress = I;
+  for(int plane = 0; plane < screenPlaneCount; plane++) {
+    if(!(selectedPlanes & (1 << plane))) {
+      continue;
+    }
+
+    for(int i = 0; i < spriteHeight; i++) {
+      int row = y + i;
+      if(row >= displayHeight) {
+        if(!quirkWrapsSprites) {
+          break;
+        }
+        row -= displayHeight;
+      }
+
+      uint64_t spriteBits = 0;
+      for(int j = 0; j < bytesPerRow; j++) {
+        spriteBits = (spriteBits << 8) | RAM[(unsigned short)(spriteAddress + i * bytesPerRow + j)];
+      }
+
+      uint64_t mask[screenWordsPerRow] = {spriteBits << (64 - spriteWidth), 0};
+      shiftRowRight(mask, x);
+
+      const int overflow = x + spriteWidth - displayWidth;
+      if(overflow > 0 && quirkWrapsSprites) {
+        mask[0] |= spriteBits << (64 - overflow);
+      }
+      if(displayWidth == lowResScreenWidth) {
+        mask[1] = 0;
+      }
+
+      uint64_t* displayRow = displayPlanes[plane][row];
+      for(int word = 0; word < screenWordsPerRow; word++) {
+        if(displayRow[word] & mask[word]) {
+          V[15] = 0x01;
+        }
+        displayRow[word] ^= mask[word];
+      }
+    }
+
+    spriteAddress += spriteHeight * bytesPerRow;
+  }
 }
 
 // Returns whether or not to simulate halting for opcode Fx0A
 int CHIP8::CPUCycle() {
-  currentOpcode = (RAM[pc] << 8) | RAM[pc + 1];
+  currentOpcode = (RAM[pc] << 8) | RAM[(unsigned short)(pc + 1)];
 
   const unsigned char xNibble = (currentOpcode & 0x0F00) >> 8; // Second opcode nibble.
   const unsigned char yNibble = (currentOpcode & 0x00F0) >> 4; // Third opcode nibble.
@@ -115,15 +331,53 @@ int CHIP8::CPUCycle() {
       switch(currentOpcode) {
         // 00E0 - CLS
         case 0x00E0:
-          std::fill_n(graphicOutput, screenPixelCount, 0);
+          clearSelectedPlanes();
           break;
         // 00EE - RET
         case 0x00EE:
           stackPointer--;
           pc = stack[stackPointer];
           break;
-        // 0nnn - SYS addr (ignored by most compilers)
+        // 00FB - SCR (SUPER-CHIP, Scroll Right 4 pixels)
+        case 0x00FB:
+          if(variant != Variant::CHIP_8) {
+            scrollHorizontally(4);
+          }
+          break;
+        // 00FC - SCL (SUPER-CHIP, Scroll Left 4 pixels)
+        case 0x00FC:
+          if(variant != Variant::CHIP_8) {
+            scrollHorizontally(-4);
+          }
+          break;
+        // 00FD - EXIT (SUPER-CHIP), the interpretor stops by repeating this instruction.
+        case 0x00FD:
+          if(variant != Variant::CHIP_8) {
+            pc -= 2;
+          }
+          break;
+        // 00FE - LOW (SUPER-CHIP, 64x32 mode)
+        case 0x00FE:
+          if(variant != Variant::CHIP_8) {
+            setResolution(false);
+          }
+          break;
+        // 00FF - HIGH (SUPER-CHIP, 128x64 mode)
+        case 0x00FF:
+          if(variant != Variant::CHIP_8) {
+            setResolution(true);
+          }
+          break;
         default:
+          // 00Cn - SCD nibble (SUPER-CHIP, Scroll Down)
+          if((currentOpcode & 0xFFF0) == 0x00C0 && variant != Variant::CHIP_8) {
+            scrollVertically(nNibble);
+          }
+          // 00Dn - SCU nibble (XO-CHIP, Scroll Up)
+          else if((currentOpcode & 0xFFF0) == 0x00D0 && variant == Variant::XO_CHIP) {
+            scrollVertically(-nNibble);
+          }
+          // 0nnn - SYS addr (ignored by most compilers)
           break;
       }
       break;
@@ -142,19 +396,43 @@ int CHIP8::CPUCycle() {
     // 3xkk - SE Vx, byte (Skip Equal)
     case 0x3000:
       if(V[xNibble] == kkByte) {
-        pc += 0x2;
+        skipNextInstruction();
       }
       break;
     // 4xkk - SNE Vx, byte (Skip Not Equal) 
     case 0x4000:
       if(V[xNibble] != kkByte) {
-        pc += 0x2;
+        skipNextInstruction();
       }
       break;
-    // 5xy0 - SE Vx, Vy (Skip Equal)
     case 0x5000:
-      if(V[xNibble] == V[yNibble]) {
-        pc += 0x2;
+      switch(nNibble) {
+        // 5xy0 - SE Vx, Vy (Skip Equal)
+        case 0x0000:
+          if(V[xNibble] == V[yNibble]) {
+            skipNextInstruction();
+          }
+          break;
+        // 5xy2 - LD [I], Vx - Vy (XO-CHIP, registers may be stored in descending order, I is unchanged)
+        case 0x0002:
+          if(variant == Variant::XO_CHIP) {
+            int step = (xNibble <= yNibble) ? 1 : -1;
+            for(int j = 0; j <= std::abs(yNibble - xNibble); j++) {
+              RAM[(unsigned short)(I + j)] = V[xNibble + j * step];
+            }
+          }
+          break;
+        // 5xy3 - LD Vx - Vy, [I] (XO-CHIP, registers may be loaded in descending order, I is unchanged)
+        case 0x0003:
+          if(variant == Variant::XO_CHIP) {
+            int step = (xNibble <= yNibble) ? 1 : -1;
+            for(int j = 0; j <= std::abs(yNibble - xNibble); j++) {
+              V[xNibble + j * step] = RAM[(unsigned short)(I + j)];
+            }
+          }
+          break;
+        default:
+          break;
       }
       break;
     // 6xkk - LD Vx, byte
@@ -174,17 +452,23 @@ int CHIP8::CPUCycle() {
         // 8xy1 - OR Vx, Vy
         case 0x0001:
           V[xNibble] |= V[yNibble];
-          V[15] = 0x00;
+          if(quirkResetsFlag) {
+            V[15] = 0x00;
+          }
           break;
         // 8xy2 - AND Vx, Vy
         case 0x0002:
           V[xNibble] &= V[yNibble];
-          V[15] = 0x00;
+          if(quirkResetsFlag) {
+            V[15] = 0x00;
+          }
           break;
         // 8xy3 - XOR Vx, Vy
         case 0x0003:
           V[xNibble] ^= V[yNibble];
-          V[15] = 0x00;
+          if(quirkResetsFlag) {
+            V[15] = 0x00;
+          }
           break;
         // 8xy4 - ADD Vx, Vy
         case 0x0004:
@@ -205,7 +489,7 @@ int CHIP8::CPUCycle() {
         // 8xy6 - SHR Vx {, Vy} (Shift Right)
         case 0x0006:
           {
-            unsigned char unshifted = V[yNibble];
+            unsigned char unshifted = quirkShiftsVx ? V[xNibble] : V[yNibble];
             V[xNibble] = unshifted >> 1;
             V[15] = ((unshifted & 0x01) == 0x01);
           }
@@ -221,7 +505,7 @@ int CHIP8::CPUCycle() {
         // 8xyE - SHL Vx {, Vy} (Shift Left)
         case 0x000E:
           {
-            unsigned char unshifted = V[yNibble];
+            unsigned char unshifted = quirkShiftsVx ? V[xNibble] : V[yNibble];
             V[xNibble] = unshifted << 1;
             V[15] = ((unshifted & 0x80) == 0x80);
           }
@@ -233,16 +517,16 @@ int CHIP8::CPUCycle() {
     // 9xy0 - SNE Vx, Vy
     case 0x9000:
       if(V[xNibble] != V[yNibble]) {
-        pc += 0x2;
+        skipNextInstruction();
       }
       break;
     // Annn - LD I, addr
     case 0xA000:
       I = nnn;
       break;
-    // Bnnn - JP V0, addr
+    // Bnnn - JP V0, addr (Bxnn - JP Vx, addr on SUPER-CHIP)
     case 0xB000:
-      pc = nnn + V[0];
+      pc = nnn + (quirkJumpsWithVx ? V[xNibble] : V[0]);
       pc -= 2;
       break;
     // Cxkk - RND Vx, byte
@@ -251,47 +535,20 @@ int CHIP8::CPUCycle() {
       break;
     // Dxyn - DRW Vx, Vy, nibble
     case 0xD000:
-      {
-        // Carry flag set to 0 by default, 1 if a pixel is erased when drawing.
-        V[15] = 0x00;
-
-        // Screen wraps only occur if entire sprite would be drawn off screen.
-        const bool horizontalWraparound = ((V[xNibble] % screenWidth) <= (screenWidth - 8));
-        const bool verticalWraparound = ((V[yNibble] % screenHeight) <= (screenHeight - nNibble));
-
-        for(int i = 0; i < nNibble; i++) {
-            if((V[yNibble] + i) > (screenHeight - 1) && !verticalWraparound) {
-              break;
-            }
-
-            for(int j = 0; j < 8; j++) {
-              if((V[xNibble] + j) > (screenWidth - 1) && !horizontalWraparound) {
-                break;
-              }
-
-              int currentTargetedPixel = (V[xNibble] + j) % screenWidth + ((V[yNibble] + i) % screenHeight) * screenWidth;
-              bool modifyPixel = ((RAM[I + i] >> (7 - j)) & 0x01);
-              graphicOutput[currentTargetedPixel] ^= modifyPixel;
-              
-              if(!graphicOutput[currentTargetedPixel] && modifyPixel) {
-                V[15] = 0x01;
-              }
-            }
-        }
-      }
+      drawSprite(V[xNibble], V[yNibble], nNibble);
       break;
     case 0xE000:
       switch(kkByte) {
         // Ex9E - SKP Vx
         case 0x009E:
           if(keypadState[V[xNibble]]) {
-            pc += 0x2;
+            skipNextInstruction();
           }
           break;
         // ExA1 - SKNP Vx
         case 0x00A1:
           if(!keypadState[V[xNibble]]) {
-            pc += 0x2;
+            skipNextInstruction();
           }
           break;
         default:
@@ -300,6 +557,27 @@ int CHIP8::CPUCycle() {
       break;
     case 0xF000:
       switch(kkByte) {
+        // F000 nnnn - LD I, long addr (XO-CHIP)
+        case 0x0000:
+          if(variant == Variant::XO_CHIP && xNibble == 0) {
+            I = (RAM[(unsigned short)(pc + 2)] << 8) | RAM[(unsigned short)(pc + 3)];
+            pc += 2;
+          }
+          break;
+        // Fn01 - PLANE n (XO-CHIP)
+        case 0x0001:
+          if(variant == Variant::XO_CHIP) {
+            selectedPlanes = xNibble & 0x03;
+          }
+          break;
+        // F002 - AUDIO (XO-CHIP, load 16 byte audio pattern from I)
+        case 0x0002:
+          if(variant == Variant::XO_CHIP && xNibble == 0) {
+            for(int j = 0; j < 16; j++) {
+              audioPattern[j] = RAM[(unsigned short)(I + j)];
+            }
+          }
+          break;
         // Fx07 - LD Vx, DT
         case 0x0007:
           V[xNibble] = delayTimer;
@@ -326,26 +604,54 @@ int CHIP8::CPUCycle() {
         case 0x0029:
           I = V[xNibble] * 0x5;
           break;
+        // Fx30 - LD HF, Vx (SUPER-CHIP, large font)
+        case 0x0030:
+          if(variant != Variant::CHIP_8) {
+            I = fontSetSize + (V[xNibble] & 0x0F) * 10;
+          }
+          break;
         // Fx33 - LD B, Vx
         case 0x0033:
           RAM[I] = V[xNibble] / 100;
-          RAM[I+1] = (V[xNibble] / 10) - (RAM[I] * 10);
-          RAM[I+2] = V[xNibble] - (RAM[I] * 100) - (RAM[I+1] * 10);
+          RAM[(unsigned short)(I + 1)] = (V[xNibble] / 10) % 10;
+          RAM[(unsigned short)(I + 2)] = V[xNibble] % 10;
+          break;
+        // Fx3A - PITCH Vx (XO-CHIP)
+        case 0x003A:
+          if(variant == Variant::XO_CHIP) {
+            audioPitch = V[xNibble];
+          }
           break;
         // Fx55 - LD [I], Vx
         case 0x0055:
           // Iterator is j to avoid confusion.
           for(int j = 0; j <= xNibble; j++) {
-            RAM[I] = V[j];
-            I++;
+            RAM[(unsigned short)(I + j)] = V[j];
+          }
+          if(quirkIncrementsIndex) {
+            I += xNibble + 1;
           }
           break;
         // Fx65 - LD Vx, [I]
         case 0x0065:
           // Iterator is j to avoid confusion.
           for(int j = 0; j <= xNibble; j++) {
-            V[j] = RAM[I];
-            I++;
+            V[j] = RAM[(unsigned short)(I + j)];
+          }
+          if(quirkIncrementsIndex) {
+            I += xNibble + 1;
+          }
+          break;
+        // Fx75 - LD R, Vx (SUPER-CHIP, store registers in user flags)
+        case 0x0075:
+          if(variant != Variant::CHIP_8) {
+            std::copy(V, V + xNibble + 1, flagRegisters);
+          }
+          break;
+        // Fx85 - LD Vx, R (SUPER-CHIP, load registers from user flags)
+        case 0x0085:
+          if(variant != Variant::CHIP_8) {
+            std::copy(flagRegisters, flagRegisters + xNibble + 1, V);
           }
           break;
         default:
@@ -1,12 +1,20 @@
 #ifndef CHIP8_H
 #define CHIP8_H
 
-const int screenWidth = 64;
-const int screenHeight = 32;
-const int screenPixelCount = screenWidth * screenHeight;
+#include <cstdint>
+#include <string>
+
+const int lowResScreenWidth = 64;
+const int lowResScreenHeight = 32;
+const int highResScreenWidth = 128; // SUPER-CHIP and XO-CHIP high resolution mode.
+const int highResScreenHeight = 64;
+const int screenWordsPerRow = highResScreenWidth / 64; // Display rows are stored as 64 bit words, leftmost pixel in the most significant bit.
+const int screenPlaneCount = 2; // XO-CHIP draws to 2 bit planes, giving 4 colors.
 const int RAMSize = 4096;
+const int extendedRAMSize = 65536; // XO-CHIP can address 64KB.
 const int interpretorSize = 512;
 const int fontSetSize = 80;
+const int bigFontSetSize = 160;
 
 enum HaltState {
   NOT_HALTING = 0, // Default state, continue CPU cycles.
@@ -14,9 +22,18 @@ enum HaltState {
   AWAITING_KEY_RELEASE = 2 // CPU continues halting, exits into NOT_HALTING once key is released.
 };
 
+enum Variant {
+  CHIP_8 = 0, // Original COSMAC VIP interpretor.
+  SUPER_CHIP = 1, // Adds 128x64 mode, scrolling, and 16x16 sprites.
+  XO_CHIP = 2 // Builds on SUPER-CHIP with a second bit plane and 64KB of memory.
+};
+
+// Converts a variant name from config.json ("CHIP-8", "SUPER-CHIP", or "XO-CHIP"), unknown names give CHIP_8.
+Variant parseVariant(const std::string& variantName);
+
 class CHIP8 {
   private:
-    unsigned char RAM[RAMSize];
+    unsigned char RAM[extendedRAMSize];
     unsigned char V[16]; // CPU registers formaly named V0 - VE with the final register representing a 'carry flag'.
     unsigned short I; // Index register
     unsigned short pc; // Program counter
@@ -26,19 +43,47 @@ class CHIP8 {
     unsigned short stack[16];
     unsigned short stackPointer;
 
+    Variant variant;
+    int memorySize;
+    unsigned char selectedPlanes; // Bit mask of planes affected by drawing, clearing, and scrolling.
+    unsigned char flagRegisters[16]; // SUPER-CHIP's persistent RPL user flags.
+
+    // Quirks differ between variants, see https://github.com/Timendus/chip8-test-suite#quirks-test
+    bool quirkResetsFlag; // 8xy1, 8xy2, and 8xy3 reset VF.
+    bool quirkIncrementsIndex; // Fx55 and Fx65 increment I.
+    bool quirkWrapsSprites; // Sprites wrap around the screen edges instead of being clipped.
+    bool quirkShiftsVx; // 8xy6 and 8xyE shift Vx in place rather than Vy.
+    bool quirkJumpsWithVx; // Bnnn jumps to nnn + Vx rather than nnn + V0.
+
+    void skipNextInstruction();
+    void setResolution(bool highResolution);
+    void clearSelectedPlanes();
+    void scrollVertically(int rows);
+    void scrollHorizontally(int pixels);
+    void drawSprite(int x, int y, int height);
+
   public:
-    unsigned char graphicOutput[screenPixelCount]; // 64x32 resolution monochrome display.
+    // Bit planes of the display, only the top left displayWidth x displayHeight pixels are in use.
+    uint64_t displayPlanes[screenPlaneCount][highResScreenHeight][screenWordsPerRow];
+    int displayWidth;
+    int displayHeight;
     unsigned char keypadState[16]; // 4x4 keypad for user input.
 
     // Both timers automatically tick down at 60hz when not 0
     unsigned char delayTimer;
     unsigned char soundTimer;
 
+    // XO-CHIP audio state. Stored so programs run correctly, playback still uses the configured sine wave.
+    unsigned char audioPattern[16];
+    unsigned char audioPitch;
+
     unsigned short getLastExecutedOpcode();
+    unsigned char getRegisterValue(int registerIndex);
     void registerValueOverride(int registerIndex, int registerValue);
+    bool getPixel(int plane, int x, int y);
     void outputScreenToConsole();
-    void initialization();
+    void initialization(Variant selectedVariant = CHIP_8);
     int loadProgram(std::string fileName);
     int CPUCycle();
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include "Config.h"
+#include "embeddedAssets.h"
+
+json loadConfig() {
+  std::ifstream file("config.json");
+  if(file.is_open()) {
+    return json::parse(file);
+  }
+
+  std::cout << "Couldn't read config.json, using default configuration." << std::endl;
+  return json::parse(embeddedDefaultConfig, embeddedDefaultConfig + embeddedDefaultConfigSize);
+}
+
+// Reads an RGB color from the graphics section of config.json. Missing entries leave color unchanged.
+void readConfigColor(json& config, const char* name, int* color) {
+  if(!config["graphics"].contains(name)) {
+    return;
+  }
+
+  for(int i = 0; i < 3; i++) {
+    color[i] = config["graphics"][name][i].get<int>();
+  }
+}
+
+void readConfigPalette(json& config, int palette[4][3]) {
+  readConfigColor(config, "backgroundColorRGB", palette[0]);
+  readConfigColor(config, "primaryColorRGB", palette[1]);
+  std::copy(palette[1], palette[1] + 3, palette[2]);
+  std::copy(palette[1], palette[1] + 3, palette[3]);
+  readConfigColor(config, "secondaryColorRGB", palette[2]);
+  readConfigColor(config, "blendedColorRGB", palette[3]);
+}
@@ -0,0 +1,15 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <json/json.hpp>
+using json = nlohmann::json;
+
+// Reads config.json from the working directory, falling back to the default copy embedded at build time.
+json loadConfig();
+
+/* Reads the display palette from the graphics section of config.json as RGB values between 0 and 255.
+ * Palette entries are indexed by which planes a pixel is set in. Older config files only have a primary
+ * color, which is then used for every plane. Missing entries leave palette unchanged.
+ */
+void readConfigPalette(json& config, int palette[4][3]);
+#endif
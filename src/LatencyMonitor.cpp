@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "LatencyMonitor.h"
+
+/* Key presses that haven't reached the screen within this time after the CPU read them are assumed to have
+ * no visible effect. They're counted in the report rather than added to the display and swap histograms.
+ */
+const std::chrono::milliseconds inputSampleTimeout(500);
+
+double millisecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+LatencyHistogram::LatencyHistogram() {
+  std::fill_n(bins, histogramBinCount, 0);
+  overflowCount = 0;
+  sampleCount = 0;
+  sampleSum = 0.0;
+  sampleMax = 0.0;
+}
+
+void LatencyHistogram::addSample(double milliseconds) {
+  milliseconds = std::max(milliseconds, 0.0);
+  int bin = (int)(milliseconds * histogramBinsPerMillisecond);
+
+  if(bin < histogramBinCount) {
+    bins[bin]++;
+  }
+  else {
+    overflowCount++;
+  }
+
+  sampleCount++;
+  sampleSum += milliseconds;
+  sampleMax = std::max(sampleMax, milliseconds);
+}
+
+unsigned int LatencyHistogram::getSampleCount() {
+  return sampleCount;
+}
+
+double LatencyHistogram::getMean() {
+  return (sampleCount == 0) ? 0.0 : sampleSum / sampleCount;
+}
+
+double LatencyHistogram::getMax() {
+  return sampleMax;
+}
+
+// Returns the upper edge of the bin containing the given percentile (0 - 100), accurate to 0.1ms.
+double LatencyHistogram::getPercentile(double percentile) {
+  if(sampleCount == 0) {
+    return 0.0;
+  }
+
+  unsigned int targetRank = (unsigned int)(percentile / 100.0 * sampleCount + 0.5);
+  targetRank = std::clamp(targetRank, 1u, sampleCount);
+
+  unsigned int rank = 0;
+  for(int i = 0; i < histogramBinCount; i++) {
+    rank += bins[i];
+    if(rank >= targetRank) {
+      return std::min((double)(i + 1) / histogramBinsPerMillisecond, sampleMax);
+    }
+  }
+
+  return sampleMax;
+}
+
+std::string LatencyHistogram::getSummary(const char* name) {
+  std::stringstream summary;
+  summary << std::fixed << std::setprecision(1) << name << " p50 " << getPercentile(50) << "ms p99 " << getPercentile(99) << "ms";
+  return summary.str();
+}
+
+// Percentiles followed by a histogram in 1ms rows. Empty rows are left out to keep the report short.
+std::string LatencyHistogram::getReport(const char* name) {
+  std::stringstream report;
+  report << std::fixed << std::setprecision(2);
+  report << name << " (" << sampleCount << " samples)" << std::endl;
+
+  if(sampleCount == 0) {
+    report << std::endl;
+    return report.str();
+  }
+
+  report << "  mean " << getMean() << "ms, p50 " << getPercentile(50) << "ms, p90 " << getPercentile(90)
+         << "ms, p95 " << getPercentile(95) << "ms, p99 " << getPercentile(99) << "ms, max " << getMax() << "ms" << std::endl;
+
+  const int barWidth = 50;
+  const int rowCount = histogramRangeMilliseconds;
+  unsigned int rowCounts[rowCount + 1];
+  unsigned int largestRow = overflowCount;
+
+  for(int i = 0; i < rowCount; i++) {
+    rowCounts[i] = 0;
+    for(int j = 0; j < histogramBinsPerMillisecond; j++) {
+      rowCounts[i] += bins[i * histogramBinsPerMillisecond + j];
+    }
+    largestRow = std::max(largestRow, rowCounts[i]);
+  }
+  rowCounts[rowCount] = overflowCount;
+
+  report << std::setprecision(0);
+  for(int i = 0; i <= rowCount; i++) {
+    if(rowCounts[i] == 0) {
+      continue;
+    }
+
+    if(i < rowCount) {
+      report << "  " << std::setw(4) << i << " - " << std::setw(4) << (i + 1) << "ms | ";
+    }
+    else {
+      report << "  " << std::setw(4) << rowCount << "+        | ";
+    }
+    report << std::string((size_t)((double)rowCounts[i] / largestRow * barWidth + 0.5), '#') << " " << rowCounts[i] << std::endl;
+  }
+
+  report << std::endl;
+  return report.str();
+}
+
+LatencyMonitor::LatencyMonitor() {
+  for(InputSample& sample : inputSamples) {
+    sample.stage = InputSampleStage::INPUT_IDLE;
+  }
+  unreadPressCount = 0;
+  noVisibleChangeCount = 0;
+  std::fill_n(recentFrameTimes, overlayFrameCount, 0.0);
+  recentFrameIndex = 0;
+}
+
+void LatencyMonitor::keyPressed(int keypadIndex) {
+  if(keypadIndex < 0 || keypadIndex > 15) {
+    return;
+  }
+
+  // A press that was never read by the CPU is replaced, otherwise the in-flight press is left to finish.
+  InputSample& sample = inputSamples[keypadIndex];
+  if(sample.stage == InputSampleStage::INPUT_PRESSED) {
+    unreadPressCount++;
+  }
+  if(sample.stage == InputSampleStage::INPUT_IDLE || sample.stage == InputSampleStage::INPUT_PRESSED) {
+    sample.stage = InputSampleStage::INPUT_PRESSED;
+    sample.pressTime = std::chrono::steady_clock::now();
+  }
+}
+
+void LatencyMonitor::keyObserved(int keypadIndex) {
+  if(keypadIndex < 0 || keypadIndex > 15) {
+    return;
+  }
+
+  // Presses wait for the CPU however long it takes, so slow reads are recorded here rather than cut off.
+  InputSample& sample = inputSamples[keypadIndex];
+  if(sample.stage == InputSampleStage::INPUT_PRESSED) {
+    sample.stage = InputSampleStage::INPUT_OBSERVED;
+    sample.observedTime = std::chrono::steady_clock::now();
+    inputToObserved.addSample(millisecondsBetween(sample.pressTime, sample.observedTime));
+  }
+}
+
+// Should be called with the display contents right before they are submitted for drawing.
+void LatencyMonitor::frameRendered(const unsigned char* display, int displaySize) {
+  bool displayChanged = (lastDisplayedFrame.size() != (size_t)displaySize) ||
+                        (std::memcmp(lastDisplayedFrame.data(), display, displaySize) != 0);
+  if(displayChanged) {
+    lastDisplayedFrame.assign(display, display + displaySize);
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  for(InputSample& sample : inputSamples) {
+    if(sample.stage != InputSampleStage::INPUT_OBSERVED) {
+      continue;
+    }
+
+    if(displayChanged) {
+      sample.stage = InputSampleStage::INPUT_DISPLAYED;
+      sample.displayTime = now;
+    }
+    else if(now - sample.observedTime > inputSampleTimeout) {
+      noVisibleChangeCount++;
+      sample.stage = InputSampleStage::INPUT_IDLE;
+    }
+  }
+}
+
+void LatencyMonitor::bufferSwapped() {
+  auto now = std::chrono::steady_clock::now();
+  for(InputSample& sample : inputSamples) {
+    if(sample.stage != InputSampleStage::INPUT_DISPLAYED) {
+      continue;
+    }
+
+    inputToDisplayChange.addSample(millisecondsBetween(sample.pressTime, sample.displayTime));
+    inputToSwap.addSample(millisecondsBetween(sample.pressTime, now));
+    sample.stage = InputSampleStage::INPUT_IDLE;
+  }
+}
+
+void LatencyMonitor::recordFrame(double frameMilliseconds, double emulationMilliseconds, double sleepOvershootMilliseconds) {
+  frameTime.addSample(frameMilliseconds);
+  emulationTime.addSample(emulationMilliseconds);
+  sleepOvershoot.addSample(sleepOvershootMilliseconds);
+
+  recentFrameTimes[recentFrameIndex] = frameMilliseconds;
+  recentFrameIndex = (recentFrameIndex + 1) % overlayFrameCount;
+}
+
+double LatencyMonitor::getRecentFrameTime(int framesAgo) {
+  int index = ((recentFrameIndex - 1 - framesAgo) % overlayFrameCount + overlayFrameCount) % overlayFrameCount;
+  return recentFrameTimes[index];
+}
+
+std::string LatencyMonitor::getSummary() {
+  return frameTime.getSummary("frame") + " | " + inputToSwap.getSummary("input to swap");
+}
+
+int LatencyMonitor::writeLog(std::string fileName) {
+  std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+  if(!file.is_open()) {
+    return -1;
+  }
+
+  file << "EMUL-8 latency report" << std::endl << std::endl;
+  file << inputToObserved.getReport("Key press to first CPU read");
+  file << "Key presses replaced before the CPU read them: " << unreadPressCount << std::endl;
+  file << "Key presses read with no display change within " << inputSampleTimeout.count() << "ms: " << noVisibleChangeCount << std::endl << std::endl;
+  file << inputToDisplayChange.getReport("Key press to first changed frame");
+  file << inputToSwap.getReport("Key press to buffer swap");
+  file << frameTime.getReport("Frame time");
+  file << emulationTime.getReport("Emulation time");
+  file << sleepOvershoot.getReport("Sleep overshoot");
+  return 0;
+}
@@ -0,0 +1,79 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+const int histogramBinsPerMillisecond = 10;
+const int histogramRangeMilliseconds = 250; // Slower samples land in an overflow bin.
+const int histogramBinCount = histogramRangeMilliseconds * histogramBinsPerMillisecond;
+const int overlayFrameCount = 120; // Number of recent frames kept for the on-screen frame time graph.
+
+// Fixed size histogram so memory use doesn't grow with session length. Percentiles are read from the bins.
+class LatencyHistogram {
+  private:
+    unsigned int bins[histogramBinCount];
+    unsigned int overflowCount;
+    unsigned int sampleCount;
+    double sampleSum;
+    double sampleMax;
+
+  public:
+    LatencyHistogram();
+    void addSample(double milliseconds);
+    unsigned int getSampleCount();
+    double getMean();
+    double getMax();
+    double getPercentile(double percentile);
+    std::string getSummary(const char* name);
+    std::string getReport(const char* name);
+};
+
+enum InputSampleStage {
+  INPUT_IDLE = 0, // No key press is being tracked.
+  INPUT_PRESSED = 1, // Key was pressed, waiting for the CPU to read it.
+  INPUT_OBSERVED = 2, // CPU read the key, waiting for the display to change.
+  INPUT_DISPLAYED = 3 // Display changed, waiting for the buffer swap to return.
+};
+
+struct InputSample {
+  InputSampleStage stage;
+  std::chrono::steady_clock::time_point pressTime;
+  std::chrono::steady_clock::time_point observedTime;
+  std::chrono::steady_clock::time_point displayTime;
+};
+
+/* Tracks the path of each key press from keyCallback, through the CPU cycle that first reads it, to
+ * the first frame showing a changed display and the glfwSwapBuffers call presenting that frame. Frame
+ * pacing (frame time, emulation time, and sleep overshoot) is recorded alongside it.
+ */
+class LatencyMonitor {
+  private:
+    InputSample inputSamples[16]; // One per keypad key.
+    std::vector<unsigned char> lastDisplayedFrame;
+
+    LatencyHistogram inputToObserved;
+    LatencyHistogram inputToDisplayChange;
+    LatencyHistogram inputToSwap;
+    LatencyHistogram frameTime;
+    LatencyHistogram emulationTime;
+    LatencyHistogram sleepOvershoot;
+    unsigned int unreadPressCount; // Presses replaced by a later press of the same key before the CPU read them.
+    unsigned int noVisibleChangeCount; // Presses the CPU read that didn't change the display within inputSampleTimeout.
+
+    double recentFrameTimes[overlayFrameCount];
+    int recentFrameIndex;
+
+  public:
+    LatencyMonitor();
+    void keyPressed(int keypadIndex);
+    void keyObserved(int keypadIndex);
+    void frameRendered(const unsigned char* display, int displaySize);
+    void bufferSwapped();
+    void recordFrame(double frameMilliseconds, double emulationMilliseconds, double sleepOvershootMilliseconds);
+    double getRecentFrameTime(int framesAgo);
+    std::string getSummary();
+    int writeLog(std::string fileName);
+};
+#endif
@@ -0,0 +1,248 @@
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "TerminalRenderer.h"
+
+// Never produced by buildCell, marks cells that have to be redrawn.
+const uint16_t invalidCell = 0xFFFF;
+
+// Braille dot bits for each pixel of a 2x4 cell, indexed by [row][column].
+const uint8_t brailleDots[4][2] = {
+  {0x01, 0x08},
+  {0x02, 0x10},
+  {0x04, 0x20},
+  {0x40, 0x80}
+};
+
+TerminalRenderer::TerminalRenderer(TerminalGlyphs selectedGlyphs, bool useTrueColor) {
+  preferredGlyphs = selectedGlyphs;
+  glyphs = selectedGlyphs;
+  trueColor = useTrueColor;
+  terminalColumns = 0;
+  terminalRows = 0;
+  cellColumns = 0;
+  cellRows = 0;
+  currentForeground = -1;
+  currentBackground = -1;
+  redrawAll = true;
+  std::memset(previousPlanes, 0, sizeof(previousPlanes));
+  output.reserve(64 * 1024);
+
+  for(int i = 0; i < 4; i++) {
+    setPaletteColor(i, (i == 0) ? 0 : 255, (i == 0) ? 0 : 255, (i == 0) ? 0 : 255);
+  }
+}
+
+void TerminalRenderer::setPaletteColor(int index, int red, int green, int blue) {
+  std::string color = std::to_string(red) + ";" + std::to_string(green) + ";" + std::to_string(blue) + "m";
+  foregroundCodes[index] = "\x1b[38;2;" + color;
+  backgroundCodes[index] = "\x1b[48;2;" + color;
+}
+
+// Clears the terminal and hides the cursor. The next draw sends every cell.
+void TerminalRenderer::begin() {
+  updateTerminalSize();
+  output = "\x1b[?25l\x1b[0m\x1b[2J";
+  writeOutput();
+  redrawAll = true;
+}
+
+// Restores the terminal's attributes and cursor, leaving it below the last drawn row.
+void TerminalRenderer::end() {
+  output = "\x1b[0m\x1b[" + std::to_string(cellRows + 1) + ";1H\x1b[?25h";
+  writeOutput();
+}
+
+// Should be called whenever the terminal is resized. The next draw clears the screen and picks glyphs that fit.
+void TerminalRenderer::updateTerminalSize() {
+  struct winsize size;
+  if(ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_col > 0 && size.ws_row > 0) {
+    terminalColumns = size.ws_col;
+    terminalRows = size.ws_row;
+  }
+  else {
+    terminalColumns = 0;
+    terminalRows = 0;
+  }
+
+  cellColumns = 0;
+  cellRows = 0;
+}
+
+// Terminals of unknown size are assumed to be big enough.
+bool TerminalRenderer::fitsTerminal(int columns, int rows) {
+  if(terminalColumns == 0 || terminalRows == 0) {
+    return true;
+  }
+  return columns <= terminalColumns && rows <= terminalRows;
+}
+
+void TerminalRenderer::bell() {
+  output = "\a";
+  writeOutput();
+}
+
+/* Half block cells hold the top pixel's palette index in bits 0-1 and the bottom pixel's in bits 2-3.
+ * Braille cells hold the dot pattern in bits 0-7 and the combined palette index of all set pixels above it.
+ */
+uint16_t TerminalRenderer::buildCell(CHIP8& chip8, int column, int row) {
+  if(glyphs == TerminalGlyphs::HALF_BLOCK) {
+    int x = column;
+    int y = row * 2;
+    int top = chip8.getPixel(0, x, y) | (chip8.getPixel(1, x, y) << 1);
+    int bottom = chip8.getPixel(0, x, y + 1) | (chip8.getPixel(1, x, y + 1) << 1);
+    return top | (bottom << 2);
+  }
+
+  uint16_t dots = 0;
+  uint16_t colorIndex = 0;
+  for(int i = 0; i < 4; i++) {
+    for(int j = 0; j < 2; j++) {
+      int x = column * 2 + j;
+      int y = row * 4 + i;
+      int pixel = chip8.getPixel(0, x, y) | (chip8.getPixel(1, x, y) << 1);
+      if(pixel != 0) {
+        dots |= brailleDots[i][j];
+        colorIndex |= pixel;
+      }
+    }
+  }
+  return dots | (colorIndex << 8);
+}
+
+// Color codes are only sent when they differ from the previous cell's.
+void TerminalRenderer::appendColors(int foreground, int background) {
+  if(foreground != currentForeground) {
+    output += foregroundCodes[foreground];
+    currentForeground = foreground;
+  }
+  if(background != currentBackground) {
+    output += backgroundCodes[background];
+    currentBackground = background;
+  }
+}
+
+// Appends the escape codes and UTF-8 glyph for one cell.
+void TerminalRenderer::appendCell(uint16_t cell) {
+  if(glyphs == TerminalGlyphs::HALF_BLOCK) {
+    int top = cell & 0x03;
+    int bottom = (cell >> 2) & 0x03;
+
+    // Upper half block drawn with the top pixel as the foreground and the bottom pixel as the background.
+    if(trueColor) {
+      appendColors(top, bottom);
+      output += "\xe2\x96\x80";
+    }
+    else if(top && bottom) {
+      output += "\xe2\x96\x88"; // Full block
+    }
+    else if(top) {
+      output += "\xe2\x96\x80"; // Upper half block
+    }
+    else if(bottom) {
+      output += "\xe2\x96\x84"; // Lower half block
+    }
+    else {
+      output += ' ';
+    }
+    return;
+  }
+
+  uint8_t dots = cell & 0xFF;
+  if(trueColor) {
+    appendColors(cell >> 8, 0);
+  }
+
+  // Braille patterns start at U+2800 with the dot pattern as the low byte.
+  output += (char)0xE2;
+  output += (char)(0xA0 | (dots >> 6));
+  output += (char)(0x80 | (dots & 0x3F));
+}
+
+void TerminalRenderer::writeOutput() {
+  const char* data = output.data();
+  size_t remaining = output.size();
+  while(remaining > 0) {
+    ssize_t written = write(STDOUT_FILENO, data, remaining);
+    if(written <= 0) {
+      break;
+    }
+    data += written;
+    remaining -= written;
+  }
+  output.clear();
+}
+
+void TerminalRenderer::draw(CHIP8& chip8) {
+  // Output wider or taller than the terminal wraps and breaks cursor positioning, braille needs half as many cells.
+  TerminalGlyphs fittingGlyphs = preferredGlyphs;
+  if(fittingGlyphs == TerminalGlyphs::HALF_BLOCK && !fitsTerminal(chip8.displayWidth, chip8.displayHeight / 2)) {
+    fittingGlyphs = TerminalGlyphs::BRAILLE;
+  }
+
+  const int pixelColumnsPerCell = (fittingGlyphs == TerminalGlyphs::HALF_BLOCK) ? 1 : 2;
+  const int pixelRowsPerCell = (fittingGlyphs == TerminalGlyphs::HALF_BLOCK) ? 2 : 4;
+  const int columns = chip8.displayWidth / pixelColumnsPerCell;
+  const int rows = chip8.displayHeight / pixelRowsPerCell;
+
+  // Switching resolution or glyphs leaves old cells behind, so the screen is cleared and drawn from scratch.
+  if(columns != cellColumns || rows != cellRows || fittingGlyphs != glyphs) {
+    glyphs = fittingGlyphs;
+    cellColumns = columns;
+    cellRows = rows;
+    previousCells.assign(cellColumns * cellRows, invalidCell);
+    output += "\x1b[0m\x1b[2J";
+    redrawAll = true;
+  }
+
+  // Nothing is drawn until the terminal is resized, the message is only written once.
+  if(!fitsTerminal(cellColumns, cellRows)) {
+    if(redrawAll) {
+      output += "\x1b[1;1HTerminal too small, needs at least " + std::to_string(cellColumns) + "x" + std::to_string(cellRows) + " characters.";
+      writeOutput();
+      redrawAll = false;
+    }
+    return;
+  }
+
+  currentForeground = -1;
+  currentBackground = -1;
+
+  const int rowSize = sizeof(chip8.displayPlanes[0][0]);
+  for(int row = 0; row < cellRows; row++) {
+    bool rowChanged = redrawAll;
+    for(int plane = 0; plane < screenPlaneCount && !rowChanged; plane++) {
+      rowChanged = std::memcmp(chip8.displayPlanes[plane][row * pixelRowsPerCell], previousPlanes[plane][row * pixelRowsPerCell], rowSize * pixelRowsPerCell) != 0;
+    }
+    if(!rowChanged) {
+      continue;
+    }
+
+    // The cursor only needs to be moved when skipping over unchanged cells.
+    int cursorColumn = -1;
+    for(int column = 0; column < cellColumns; column++) {
+      uint16_t cell = buildCell(chip8, column, row);
+      uint16_t& previousCell = previousCells[row * cellColumns + column];
+      if(cell == previousCell) {
+        continue;
+      }
+
+      if(cursorColumn != column) {
+        output += "\x1b[" + std::to_string(row + 1) + ";" + std::to_string(column + 1) + "H";
+      }
+      appendCell(cell);
+      previousCell = cell;
+      cursorColumn = column + 1;
+    }
+  }
+
+  std::memcpy(previousPlanes, chip8.displayPlanes, sizeof(previousPlanes));
+  redrawAll = false;
+
+  if(!output.empty()) {
+    if(trueColor) {
+      output += "\x1b[0m";
+    }
+    writeOutput();
+  }
+}
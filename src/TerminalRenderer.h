@@ -0,0 +1,52 @@
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CHIP8.h"
+
+enum TerminalGlyphs {
+  HALF_BLOCK = 0, // 1x2 pixels per cell, both pixels keep their own color.
+  BRAILLE = 1 // 2x4 pixels per cell, one color per cell.
+};
+
+/* Draws the CHIP8 display into a terminal using ANSI escape codes. Only cells that changed since the
+ * previous frame are sent, and each frame is written with a single system call. Display rows that are
+ * unchanged in every plane are skipped before any cells are built.
+ */
+class TerminalRenderer {
+  private:
+    TerminalGlyphs preferredGlyphs; // Glyphs chosen in config.json.
+    TerminalGlyphs glyphs; // Glyphs in use, half blocks fall back to braille when the terminal is too small.
+    bool trueColor;
+    std::string foregroundCodes[4]; // SGR sequences for each palette entry.
+    std::string backgroundCodes[4];
+    int currentForeground; // Palette entries last sent in this frame, -1 if unknown.
+    int currentBackground;
+
+    int terminalColumns; // Size of the terminal in characters, 0 if it couldn't be queried.
+    int terminalRows;
+    int cellColumns;
+    int cellRows;
+    std::vector<uint16_t> previousCells;
+    uint64_t previousPlanes[screenPlaneCount][highResScreenHeight][screenWordsPerRow];
+    bool redrawAll;
+    std::string output;
+
+    uint16_t buildCell(CHIP8& chip8, int column, int row);
+    void appendColors(int foreground, int background);
+    void appendCell(uint16_t cell);
+    void writeOutput();
+    bool fitsTerminal(int columns, int rows);
+
+  public:
+    TerminalRenderer(TerminalGlyphs selectedGlyphs, bool useTrueColor);
+    void setPaletteColor(int index, int red, int green, int blue);
+    void begin();
+    void end();
+    void updateTerminalSize();
+    void draw(CHIP8& chip8);
+    void bell();
+};
+#endif
@@ -5,13 +5,17 @@
 #include <thread>
 #include <cstring>
 #include <cassert>
+#include <filesystem>
+#include <random>
+#include <cstdlib>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
-#include <json/json.hpp>
-using json = nlohmann::json;
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 #include "CHIP8.h"
+#include "Config.h"
+#include "LatencyMonitor.h"
+#include "embeddedAssets.h"
 
 // The miniaudio library contains one reference to MA_ASSERT before it is defined. To avoid issues in compilation it is defined here.
 #ifndef MA_ASSERT
@@ -26,8 +30,11 @@ CHIP8 Chip8;
  * While a dedicated settings menu doesn't exist I believe this is a nice middle ground of providing
  * user customization without increasing project scope far beyond what I desire.
  */
-std::ifstream f("config.json");
-json config = json::parse(f);
+json config;
+
+// Startup is split into phases that are timed individually so time-to-first-frame can be tracked.
+std::chrono::steady_clock::time_point startupTime;
+std::chrono::steady_clock::time_point startupPhaseTime;
 
 ma_format audioDeviceFormat = ma_format_f32;
 int audioDeviceChannels = 2;
@@ -39,9 +46,15 @@ int keyPressedDuringHalt = 0;
 
 int keyMap[16];
 
+// Latency instrumentation is optional and configured in the "instrumentation" section of config.json.
+LatencyMonitor latencyMonitor;
+bool latencyMonitorEnabled = false;
+bool latencyOverlayEnabled = false;
+
 const int windowWidth = 640;
 const int windowHeight = 360;
 const int pixelSize = 10;
+const std::chrono::milliseconds frameDuration(16);
 
 // Updates keypadState. Checks conditions to exit states where cpu is halted. Runs everytime user interacts with keyboard.
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
@@ -61,10 +74,19 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
     i++;
   }
 
+  if(latencyMonitorEnabled && keyIsPressedDown) {
+    latencyMonitor.keyPressed(i);
+  }
+
   if(currentHaltState == HaltState::AWAITING_KEY_PRESS && keyIsPressedDown) {
     int registerIndex = (Chip8.getLastExecutedOpcode() & 0x0F00) >> 8;
     Chip8.registerValueOverride(registerIndex, i);
 
+    // The halted Fx0A instruction consumes the key immediately, so this counts as the CPU reading it.
+    if(latencyMonitorEnabled) {
+      latencyMonitor.keyObserved(i);
+    }
+
     keyPressedDuringHalt = key;
     currentHaltState = HaltState::AWAITING_KEY_RELEASE;
   }
@@ -92,29 +114,76 @@ void dataCallback(ma_device* device, void* output, const void* input, ma_uint32
   (void)input;
 }
 
-std::string readFile(char* filename) {
-  std::ifstream file;
-  std::stringstream buffer;
-  std::string ret;
+// Prints how long the startup phase that just finished took along with the total time since launch.
+void reportStartupPhase(const char* phaseName) {
+  auto now = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> phaseDuration = now - startupPhaseTime;
+  std::chrono::duration<double, std::milli> totalDuration = now - startupTime;
+  std::cout << "Startup: " << phaseName << " took " << phaseDuration.count() << "ms (" << totalDuration.count() << "ms total)" << std::endl;
+  startupPhaseTime = now;
+}
 
-  file.open(filename);
-  if(!file.is_open()) {
-    std::cout << "Couldn't read file: " << filename << std::endl;
-    return "";
+/* Draws the most recent frame times as a bar graph along the bottom of the window, newest on the right.
+ * Bars are drawn with scissored clears so the overlay doesn't need its own shaders or buffers. The
+ * horizontal line marks the frame budget and bars exceeding it by more than 10% are drawn in red.
+ */
+void drawLatencyOverlay(GLFWwindow* window, float* backgroundColor) {
+  const double frameBudget = std::chrono::duration<double, std::milli>(frameDuration).count();
+  const double graphRange = frameBudget * 2.0;
+
+  int framebufferWidth, framebufferHeight;
+  glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+  int graphHeight = framebufferHeight / 4;
+  int barWidth = std::max(1, framebufferWidth / overlayFrameCount);
+
+  glEnable(GL_SCISSOR_TEST);
+  for(int i = 0; i < overlayFrameCount; i++) {
+    int barX = framebufferWidth - (i + 1) * barWidth;
+    if(barX < 0) {
+      break;
+    }
+
+    double frameMilliseconds = latencyMonitor.getRecentFrameTime(i);
+    int barHeight = std::min(graphHeight, (int)(frameMilliseconds / graphRange * graphHeight));
+    if(frameMilliseconds > frameBudget * 1.1) {
+      glClearColor(0.9f, 0.2f, 0.2f, 1.0f);
+    }
+    else {
+      glClearColor(0.2f, 0.8f, 0.3f, 1.0f);
+    }
+    glScissor(barX, 0, std::max(1, barWidth - 1), barHeight);
+    glClear(GL_COLOR_BUFFER_BIT);
   }
 
-  buffer << file.rdbuf();
-  ret = buffer.str();
-  file.close();
-  return ret;
+  glClearColor(0.9f, 0.8f, 0.2f, 1.0f);
+  glScissor(0, (int)(frameBudget / graphRange * graphHeight), framebufferWidth, 1);
+  glClear(GL_COLOR_BUFFER_BIT);
+  glDisable(GL_SCISSOR_TEST);
+
+  glClearColor(backgroundColor[0]/255.0f, backgroundColor[1]/255.0f, backgroundColor[2]/255.0f, 1.0f);
+}
+
+/* Splits the display's 64 bit words into 32 bit texels for upload, high half first so the leftmost
+ * pixel stays in the most significant bit regardless of byte order. The second plane's rows follow
+ * the first's.
+ */
+void packDisplayTexels(uint32_t* texels) {
+  for(int plane = 0; plane < screenPlaneCount; plane++) {
+    for(int i = 0; i < highResScreenHeight; i++) {
+      for(int word = 0; word < screenWordsPerRow; word++) {
+        uint64_t pixels = Chip8.displayPlanes[plane][i][word];
+        *texels++ = (uint32_t)(pixels >> 32);
+        *texels++ = (uint32_t)pixels;
+      }
+    }
+  }
 }
 
-int generateShader(char* filename, GLenum type) {
-  std::string shaderSource = readFile(filename);
-  const GLchar* shader = shaderSource.c_str();
+int generateShader(const unsigned char* source, GLint sourceLength, GLenum type) {
+  const GLchar* shader = (const GLchar*)source;
 
   int shaderObj = glCreateShader(type);
-  glShaderSource(shaderObj, 1, &shader, NULL);
+  glShaderSource(shaderObj, 1, &shader, &sourceLength);
   glCompileShader(shaderObj);
 
   int shaderCompiled;
@@ -129,28 +198,222 @@ int generateShader(char* filename, GLenum type) {
   return shaderObj;
 }
 
-int generateShaderProgram(char* vertexShaderPath, char* fragmentShaderPath, char* geometryShaderPath) {
-  int shaderProgram = glCreateProgram();
+/* The program binary cache needs a glad loader generated for OpenGL 4.1 or with GL_ARB_get_program_binary.
+ * Loaders generated for 3.3 alone build without it and always compile the shaders.
+ */
+#if defined(GL_VERSION_4_1) || defined(GL_ARB_get_program_binary)
+#define PROGRAM_BINARY_CACHE
+
+/* Program binaries are only valid for the driver that produced them, so the cache key contains the
+ * driver's identification strings along with the shader sources. The key is hashed to name the cache
+ * file and also stored inside of it to guard against hash collisions.
+ */
+std::string getShaderCacheKey() {
+  std::string key;
+  key += (const char*)glGetString(GL_VENDOR);
+  key += "|";
+  key += (const char*)glGetString(GL_RENDERER);
+  key += "|";
+  key += (const char*)glGetString(GL_VERSION);
+  key += "|";
+  key.append((const char*)embeddedMainVert, embeddedMainVertSize);
+  key.append((const char*)embeddedMainFrag, embeddedMainFragSize);
+  return key;
+}
+
+/* Linked shader programs are cached in the user's cache directory so every launch shares them no matter
+ * the working directory, which may also be read-only. Returns an empty path if there's no such directory.
+ */
+std::filesystem::path getShaderCacheDirectory() {
+#ifdef _WIN32
+  const char* localAppData = std::getenv("LOCALAPPDATA");
+  if(localAppData != NULL && localAppData[0] != '\0') {
+    return std::filesystem::path(localAppData) / "EMUL-8" / "shaderCache";
+  }
+#else
+  const char* xdgCacheHome = std::getenv("XDG_CACHE_HOME");
+  if(xdgCacheHome != NULL && xdgCacheHome[0] != '\0') {
+    return std::filesystem::path(xdgCacheHome) / "EMUL-8" / "shaderCache";
+  }
+
+  const char* home = std::getenv("HOME");
+  if(home != NULL && home[0] != '\0') {
+    return std::filesystem::path(home) / ".cache" / "EMUL-8" / "shaderCache";
+  }
+#endif
+  return std::filesystem::path();
+}
+
+std::filesystem::path getShaderCachePath(const std::string& cacheKey) {
+  std::stringstream fileName;
+  fileName << std::hex << std::hash<std::string>{}(cacheKey) << ".bin";
+  return getShaderCacheDirectory() / fileName.str();
+}
 
-  int vShader = generateShader(vertexShaderPath, GL_VERTEX_SHADER);
-  int fShader = generateShader(fragmentShaderPath, GL_FRAGMENT_SHADER);
-  int gShader = generateShader(geometryShaderPath, GL_GEOMETRY_SHADER);
+// The context has to be 4.1 or newer or report the extension, glad only loads the functions in that case.
+bool programBinariesSupported() {
+  bool contextSupported = false;
+#ifdef GL_VERSION_4_1
+  contextSupported = contextSupported || GLAD_GL_VERSION_4_1;
+#endif
+#ifdef GL_ARB_get_program_binary
+  contextSupported = contextSupported || GLAD_GL_ARB_get_program_binary;
+#endif
+
+  GLint binaryFormatCount = 0;
+  if(!contextSupported || glGetProgramBinary == NULL || glProgramBinary == NULL || getShaderCacheDirectory().empty()) {
+    return false;
+  }
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+  return binaryFormatCount > 0;
+}
+
+// Attempts to create a program from a cached binary. Returns 0 if there is no usable cache entry.
+GLuint loadCachedShaderProgram(const std::string& cacheKey) {
+  std::ifstream file(getShaderCachePath(cacheKey), std::ios::in | std::ios::binary);
+  if(!file.is_open()) {
+    return 0;
+  }
+
+  unsigned int storedKeyLength = 0;
+  file.read((char*)&storedKeyLength, sizeof(storedKeyLength));
+  if(!file || storedKeyLength != cacheKey.size()) {
+    return 0;
+  }
+
+  std::string storedKey(storedKeyLength, '\0');
+  GLenum binaryFormat = 0;
+  file.read(&storedKey[0], storedKeyLength);
+  file.read((char*)&binaryFormat, sizeof(binaryFormat));
+  if(!file || storedKey != cacheKey) {
+    return 0;
+  }
+
+  std::string binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if(binary.empty()) {
+    return 0;
+  }
+
+  GLuint shaderProgram = glCreateProgram();
+  glProgramBinary(shaderProgram, binaryFormat, binary.data(), (GLsizei)binary.size());
+
+  // Drivers are allowed to reject binaries at any time (e.g. after an update), in which case the program is rebuilt.
+  GLint programLinked = 0;
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &programLinked);
+  if(!programLinked) {
+    glDeleteProgram(shaderProgram);
+    return 0;
+  }
+
+  return shaderProgram;
+}
+
+void storeCachedShaderProgram(GLuint shaderProgram, const std::string& cacheKey) {
+  GLint binaryLength = 0;
+  glGetProgramiv(shaderProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+  if(binaryLength <= 0) {
+    return;
+  }
+
+  std::string binary(binaryLength, '\0');
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(shaderProgram, binaryLength, NULL, &binaryFormat, &binary[0]);
+
+  /* Several instances may start at once, so the entry is written to a uniquely named temporary file and
+   * renamed into place. Readers only ever see a complete file. Failures just leave the cache empty, the
+   * program is rebuilt on the next launch.
+   */
+  std::error_code error;
+  std::filesystem::path cachePath = getShaderCachePath(cacheKey);
+  std::filesystem::create_directories(cachePath.parent_path(), error);
+  if(error) {
+    return;
+  }
+
+  std::stringstream temporaryName;
+  temporaryName << cachePath.filename().string() << "." << std::hex << std::random_device{}() << ".tmp";
+  std::filesystem::path temporaryPath = cachePath.parent_path() / temporaryName.str();
+
+  std::ofstream file(temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!file.is_open()) {
+    return;
+  }
+
+  unsigned int keyLength = (unsigned int)cacheKey.size();
+  file.write((const char*)&keyLength, sizeof(keyLength));
+  file.write(cacheKey.data(), keyLength);
+  file.write((const char*)&binaryFormat, sizeof(binaryFormat));
+  file.write(binary.data(), binary.size());
+  file.close();
+
+  if(!file) {
+    std::filesystem::remove(temporaryPath, error);
+    return;
+  }
+
+  std::filesystem::rename(temporaryPath, cachePath, error);
+  if(error) {
+    std::filesystem::remove(temporaryPath, error);
+  }
+}
+#endif
+
+GLuint generateShaderProgram() {
+#ifdef PROGRAM_BINARY_CACHE
+  bool useProgramCache = programBinariesSupported();
+  std::string cacheKey;
+
+  if(useProgramCache) {
+    cacheKey = getShaderCacheKey();
+    GLuint cachedProgram = loadCachedShaderProgram(cacheKey);
+    if(cachedProgram != 0) {
+      return cachedProgram;
+    }
+  }
+#endif
+
+  GLuint shaderProgram = glCreateProgram();
+
+  int vShader = generateShader(embeddedMainVert, embeddedMainVertSize, GL_VERTEX_SHADER);
+  int fShader = generateShader(embeddedMainFrag, embeddedMainFragSize, GL_FRAGMENT_SHADER);
 
   glAttachShader(shaderProgram, vShader);
   glAttachShader(shaderProgram, fShader);
-  glAttachShader(shaderProgram, gShader);
+#ifdef PROGRAM_BINARY_CACHE
+  if(useProgramCache) {
+    glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+#endif
   glLinkProgram(shaderProgram);
 
   glDeleteShader(vShader);
   glDeleteShader(fShader);
-  glDeleteShader(gShader);
+
+  GLint programLinked = 0;
+  glGetProgramiv(shaderProgram, GL_LINK_STATUS, &programLinked);
+#ifdef PROGRAM_BINARY_CACHE
+  if(programLinked && useProgramCache) {
+    storeCachedShaderProgram(shaderProgram, cacheKey);
+  }
+#endif
 
   return shaderProgram;
 }
 
 int main() {
+  startupTime = std::chrono::steady_clock::now();
+  startupPhaseTime = startupTime;
   std::fill_n(keypadStateBeforeHalt, 16, 0);
 
+  try {
+    config = loadConfig();
+  }
+  catch(...) {
+    std::cout << "Error parsing config.json" << std::endl;
+    return -1;
+  }
+  reportStartupPhase("config");
+
   // Step 1: setup graphics, input, and audio systems.
   // Step 1.1: GLFW and GLAD setup.
   GLFWwindow* window;
@@ -159,13 +422,13 @@ int main() {
     return -1;
   }
 
-  window = glfwCreateWindow(screenWidth * pixelSize, screenHeight * pixelSize, "EMUL-8", NULL, NULL);
+  window = glfwCreateWindow(lowResScreenWidth * pixelSize, lowResScreenHeight * pixelSize, "EMUL-8", NULL, NULL);
   glfwMakeContextCurrent(window);
   glfwSetKeyCallback(window, keyCallback);
   glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);
 
   GLFWimage icon[1];
-  icon[0].pixels = stbi_load("8).png", &icon[0].width, &icon[0].height, 0, 4);
+  icon[0].pixels = stbi_load_from_memory(embeddedIcon, embeddedIconSize, &icon[0].width, &icon[0].height, 0, 4);
 
   if(icon[0].pixels) {
     glfwSetWindowIcon(window, 1, icon);
@@ -181,34 +444,42 @@ int main() {
     return -1;
   }
 
-  framebufferSizeCallback(window, screenWidth * pixelSize, screenHeight * pixelSize);
+  framebufferSizeCallback(window, lowResScreenWidth * pixelSize, lowResScreenHeight * pixelSize);
+  reportStartupPhase("window");
 
-  GLuint shaderProgram = generateShaderProgram("shaders\\main.vert", "shaders\\main.frag", "shaders\\main.geom");
+  GLuint shaderProgram = generateShaderProgram();
   glUseProgram(shaderProgram);
-  glUniform1i(glGetUniformLocation(shaderProgram, "width"), screenWidth);
-  glUniform1f(glGetUniformLocation(shaderProgram, "cellWidth"), 2.0f / (float)(screenWidth));
-  glUniform1f(glGetUniformLocation(shaderProgram, "cellHeight"), 2.0f / (float)(screenHeight));
-
-  float primaryColor[] = {
-    config["graphics"]["primaryColorRGB"][0],
-    config["graphics"]["primaryColorRGB"][1],
-    config["graphics"]["primaryColorRGB"][2]
-  };
-  glUniform1f(glGetUniformLocation(shaderProgram, "red"), primaryColor[0]/255.0f);
-  glUniform1f(glGetUniformLocation(shaderProgram, "green"), primaryColor[1]/255.0f);
-  glUniform1f(glGetUniformLocation(shaderProgram, "blue"), primaryColor[2]/255.0f);
+  glUniform1i(glGetUniformLocation(shaderProgram, "display"), 0);
+  glUniform1i(glGetUniformLocation(shaderProgram, "planeOffset"), highResScreenHeight);
+
+  int configPalette[4][3] = {};
+  readConfigPalette(config, configPalette);
+  float palette[4][3];
+  for(int i = 0; i < 4; i++) {
+    for(int j = 0; j < 3; j++) {
+      palette[i][j] = configPalette[i][j] / 255.0f;
+    }
+  }
+  glUniform3fv(glGetUniformLocation(shaderProgram, "palette"), 4, &palette[0][0]);
 
+  // The quad covering the window is generated in the vertex shader, an empty VAO still has to be bound.
   GLuint VAO;
   glGenVertexArrays(1, &VAO);
   glBindVertexArray(VAO);
 
-  GLuint VBO;
-  glGenBuffers(1, &VBO);
-  glBindBuffer(GL_ARRAY_BUFFER, VBO);
+  // The display is uploaded as packed bit planes so upload size doesn't depend on pixel count.
+  const int displayTexelWidth = screenWordsPerRow * 2;
+  const int displayTexelHeight = screenPlaneCount * highResScreenHeight;
+  uint32_t displayTexels[displayTexelWidth * displayTexelHeight];
 
-  glBufferData(GL_ARRAY_BUFFER, screenPixelCount, Chip8.graphicOutput, GL_DYNAMIC_DRAW);
-  glEnableVertexAttribArray(0);
-  glVertexAttribIPointer(0, 1, GL_BYTE, sizeof(char), 0);
+  GLuint displayTexture;
+  glGenTextures(1, &displayTexture);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, displayTexture);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, displayTexelWidth, displayTexelHeight, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, NULL);
+  reportStartupPhase("shaders");
 
   // Step 1.2: miniaudio setup.
   ma_waveform sineWave;
@@ -237,6 +508,7 @@ int main() {
     config["audio"]["sineWaveFrequency"]
   );
   ma_waveform_init(&sineWaveConfig, &sineWave);
+  reportStartupPhase("audio");
 
   // Step 1.3: Keypad setup.
   try {
@@ -251,13 +523,20 @@ int main() {
     return -1;
   }
 
+  // Step 1.4: Latency instrumentation setup. Config files without an instrumentation section leave it disabled.
+  if(config.contains("instrumentation")) {
+    latencyMonitorEnabled = config["instrumentation"].value("enabled", false);
+    latencyOverlayEnabled = latencyMonitorEnabled && config["instrumentation"].value("overlay", false);
+  }
+
   // Step 2: Initialize Chip8 and load program.
-  Chip8.initialization();
+  Chip8.initialization(parseVariant(config["general"].value("variant", "CHIP-8")));
   int programLoaded = Chip8.loadProgram(config["general"]["romFileName"]);
   if(programLoaded != 0) {
     std::cout << "Error Accessing ROM" << std::endl;
     return -1;
   }
+  reportStartupPhase("ROM");
 
   // Step 3: Loop CPU cycles.
   float backgroundColor[] = {
@@ -267,27 +546,44 @@ int main() {
   };
   glClearColor(backgroundColor[0]/255.0f, backgroundColor[1]/255.0f, backgroundColor[2]/255.0f, 1.0f);
 
+  bool firstFramePresented = false;
+  int frameCount = 0;
   while(!glfwWindowShouldClose(window)) {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    auto startTime = std::chrono::steady_clock::now();
     glfwPollEvents();
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindTexture(GL_TEXTURE_2D, displayTexture);
+
+    packDisplayTexels(displayTexels);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, displayTexelWidth, displayTexelHeight, GL_RED_INTEGER, GL_UNSIGNED_INT, displayTexels);
 
-    GLvoid* mapPtr = glMapBuffer(GL_ARRAY_BUFFER, GL_WRITE_ONLY);
-    if (!mapPtr) {
-      std::cerr << "Failed to map buffer" << std::endl;
+    if(latencyMonitorEnabled) {
+      latencyMonitor.frameRendered((const unsigned char*)Chip8.displayPlanes, sizeof(Chip8.displayPlanes));
     }
-    std::memcpy(mapPtr, Chip8.graphicOutput, screenPixelCount);
-    glUnmapBuffer(GL_ARRAY_BUFFER);
 
     glUseProgram(shaderProgram);
-    glDrawArrays(GL_POINTS, 0, screenPixelCount);
+    glUniform2i(glGetUniformLocation(shaderProgram, "displaySize"), Chip8.displayWidth, Chip8.displayHeight);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    if(latencyOverlayEnabled) {
+      drawLatencyOverlay(window, backgroundColor);
+    }
 
     glfwSwapBuffers(window);
 
+    if(latencyMonitorEnabled) {
+      latencyMonitor.bufferSwapped();
+    }
+
+    if(!firstFramePresented) {
+      reportStartupPhase("first frame");
+      firstFramePresented = true;
+    }
+
+    auto emulationStartTime = std::chrono::steady_clock::now();
     if(currentHaltState == HaltState::NOT_HALTING) {
       for(int i = 0; i < config["general"]["cpuCyclesPerFrame"]; i++) {
         glfwPollEvents();
@@ -306,8 +602,18 @@ int main() {
             std::cout << "miniaudio couldn't start playback device." << std::endl;
           }
         }
+
+        // Ex9E and ExA1 are how programs read held keys, the first read of a pressed key is recorded.
+        bool keyRead = ((ranOpcode & 0xF0FF) == 0xE09E) || ((ranOpcode & 0xF0FF) == 0xE0A1);
+        if(latencyMonitorEnabled && keyRead) {
+          int keyIndex = Chip8.getRegisterValue((ranOpcode & 0x0F00) >> 8) & 0x0F;
+          if(Chip8.keypadState[keyIndex]) {
+            latencyMonitor.keyObserved(keyIndex);
+          }
+        }
       }
     }
+    auto emulationEndTime = std::chrono::steady_clock::now();
 
     if(Chip8.delayTimer > 0) {
       Chip8.delayTimer--;
@@ -317,7 +623,24 @@ int main() {
       Chip8.soundTimer--;
     }
     
-    std::this_thread::sleep_until(startTime + std::chrono::milliseconds(16));
+    auto wakeTime = startTime + frameDuration;
+    bool frameOverran = (std::chrono::steady_clock::now() >= wakeTime);
+    std::this_thread::sleep_until(wakeTime);
+
+    if(latencyMonitorEnabled) {
+      auto endTime = std::chrono::steady_clock::now();
+      latencyMonitor.recordFrame(
+        std::chrono::duration<double, std::milli>(endTime - startTime).count(),
+        std::chrono::duration<double, std::milli>(emulationEndTime - emulationStartTime).count(),
+        frameOverran ? 0.0 : std::chrono::duration<double, std::milli>(endTime - wakeTime).count()
+      );
+
+      // Percentiles are shown in the title bar since the overlay doesn't render text.
+      frameCount++;
+      if(latencyOverlayEnabled && frameCount % 30 == 0) {
+        glfwSetWindowTitle(window, ("EMUL-8 | " + latencyMonitor.getSummary()).c_str());
+      }
+    }
 
     if(Chip8.soundTimer == 0) {
       if(ma_device_get_state(&device) == ma_device_state_started) {
@@ -326,14 +649,21 @@ int main() {
     }
   }
 
-  // Clean up buffers and arrays
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  // Clean up textures and arrays
+  glBindTexture(GL_TEXTURE_2D, 0);
   glBindVertexArray(0);
-  glDeleteBuffers(1, &VBO);
+  glDeleteTextures(1, &displayTexture);
   glDeleteVertexArrays(1, &VAO);
 
   glDeleteProgram(shaderProgram);
 
+  if(latencyMonitorEnabled) {
+    std::string logFileName = config["instrumentation"].value("logFileName", "latency.log");
+    if(latencyMonitor.writeLog(logFileName) != 0) {
+      std::cout << "Couldn't write latency log: " << logFileName << std::endl;
+    }
+  }
+
   glfwTerminate();
   return 0;
 }
\ No newline at end of file
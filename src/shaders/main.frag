@@ -1,11 +1,23 @@
 #version 330 core
 
-uniform float red;
-uniform float green;
-uniform float blue;
+// Each texel holds 32 pixels of a display row, leftmost pixel in the most significant bit.
+// Rows of the second bit plane start planeOffset rows below the first.
+uniform usampler2D display;
+uniform ivec2 displaySize;
+uniform int planeOffset;
+uniform vec3 palette[4];
+
+in vec2 screenPosition;
 
 out vec4 color;
 
 void main() {
-  color = vec4(red, green, blue, 1.0);
+  ivec2 pixel = min(ivec2(screenPosition * vec2(displaySize)), displaySize - 1);
+  int texelX = pixel.x / 32;
+  uint bit = uint(31 - pixel.x % 32);
+
+  uint firstPlane = (texelFetch(display, ivec2(texelX, pixel.y), 0).r >> bit) & 1u;
+  uint secondPlane = (texelFetch(display, ivec2(texelX, pixel.y + planeOffset), 0).r >> bit) & 1u;
+
+  color = vec4(palette[firstPlane | (secondPlane << 1u)], 1.0);
 }
\ No newline at end of file
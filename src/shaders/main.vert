@@ -1,25 +1,12 @@
 #version 330 core
 
-// take current cell as int
-layout (location = 0) in int val;
-
-uniform int width;
-uniform float cellWidth;
-uniform float cellHeight;
-
-out VS_OUT {
-  int valid;
-} vs_out;
+// Covers the window with a quad, pixels are looked up per fragment in main.frag.
+out vec2 screenPosition;
 
 void main() {
-  if(val != 0) {
-    float row = float(gl_VertexID / width);
-    float col = float(gl_VertexID % width);
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
 
-    gl_Position = vec4(col * cellWidth - 1.0, 1.0 - (row + 1.0) * cellHeight, 0.0, 1.0);
-    vs_out.valid = 1;
-  }
-  else {
-    vs_out.valid = 0;
-  }
+  // Flipped so (0, 0) is the top left of the display.
+  screenPosition = vec2(corner.x, 1.0 - corner.y);
+  gl_Position = vec4(corner * 2.0 - 1.0, 0.0, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <csignal>
+#include <cctype>
+#include <termios.h>
+#include <unistd.h>
+#include "CHIP8.h"
+#include "Config.h"
+#include "TerminalRenderer.h"
+
+/* Terminal frontend for running over SSH or on machines without a display. It shares config.json with
+ * the windowed frontend, with the terminal section choosing glyphs and key behaviour. There's no audio
+ * output, the terminal bell rings when a sound starts instead.
+ */
+
+CHIP8 Chip8;
+json config;
+
+HaltState currentHaltState = NOT_HALTING;
+int keyPressedDuringHalt = 0;
+
+int keyMap[16];
+
+const std::chrono::milliseconds frameDuration(16);
+
+/* Terminals only report key presses (repeated while held), never releases. A key counts as held until
+ * no press has been seen for keyHoldDuration. Values longer than the keyboard's auto-repeat delay, which
+ * is commonly 250-660ms (660ms is the X11 default), stop held keys from briefly releasing. Every tap is held
+ * for this long, so shorter values make single taps more precise.
+ */
+std::chrono::milliseconds keyHoldDuration(700);
+std::chrono::steady_clock::time_point keyLastSeen[16];
+
+/* Arrow and function keys arrive as CSI (ESC [) or SS3 (ESC O) sequences ending in a byte between @ and ~.
+ * Their bytes are skipped so they don't press whichever CHIP-8 keys share those letters. The state is kept
+ * between reads in case a sequence is split.
+ */
+enum EscapeState {
+  NO_ESCAPE = 0,
+  ESCAPE_STARTED = 1, // ESC was read, waiting to see if a sequence follows.
+  IN_SEQUENCE = 2 // Inside a CSI or SS3 sequence, waiting for its final byte.
+};
+EscapeState inputEscapeState = NO_ESCAPE;
+
+struct termios originalTerminalSettings;
+volatile std::sig_atomic_t quitRequested = 0;
+volatile std::sig_atomic_t terminalResized = 0;
+
+void signalHandler(int signal) {
+  quitRequested = 1;
+}
+
+void resizeHandler(int signal) {
+  terminalResized = 1;
+}
+
+// Puts stdin into raw mode so keys are read as soon as they're typed without being echoed.
+// Reads return immediately when no key is waiting.
+int enableRawInput() {
+  if(tcgetattr(STDIN_FILENO, &originalTerminalSettings) != 0) {
+    return -1;
+  }
+
+  struct termios rawSettings = originalTerminalSettings;
+  rawSettings.c_lflag &= ~(ICANON | ECHO);
+  rawSettings.c_iflag &= ~(IXON | ICRNL);
+  rawSettings.c_cc[VMIN] = 0;
+  rawSettings.c_cc[VTIME] = 0;
+  return tcsetattr(STDIN_FILENO, TCSAFLUSH, &rawSettings);
+}
+
+void restoreInput() {
+  tcsetattr(STDIN_FILENO, TCSAFLUSH, &originalTerminalSettings);
+}
+
+// Updates keypadState and exits CPU halts the same way keyCallback does in the windowed frontend.
+void keyEvent(int keypadIndex, bool keyIsPressedDown) {
+  Chip8.keypadState[keypadIndex] = static_cast<unsigned char>(keyIsPressedDown);
+
+  if(currentHaltState == HaltState::AWAITING_KEY_PRESS && keyIsPressedDown) {
+    int registerIndex = (Chip8.getLastExecutedOpcode() & 0x0F00) >> 8;
+    Chip8.registerValueOverride(registerIndex, keypadIndex);
+
+    keyPressedDuringHalt = keypadIndex;
+    currentHaltState = HaltState::AWAITING_KEY_RELEASE;
+  }
+
+  if(currentHaltState == HaltState::AWAITING_KEY_RELEASE && !keyIsPressedDown && keyPressedDuringHalt == keypadIndex) {
+    currentHaltState = HaltState::NOT_HALTING;
+  }
+}
+
+// Reads every byte waiting on stdin, then releases keys that haven't repeated recently.
+void pollInput() {
+  auto now = std::chrono::steady_clock::now();
+  char buffer[64];
+  ssize_t bytesRead;
+
+  while((bytesRead = read(STDIN_FILENO, buffer, sizeof(buffer))) > 0) {
+    for(int i = 0; i < bytesRead; i++) {
+      unsigned char byte = (unsigned char)buffer[i];
+      if(inputEscapeState == EscapeState::IN_SEQUENCE) {
+        if(byte >= 0x40 && byte <= 0x7E) {
+          inputEscapeState = EscapeState::NO_ESCAPE;
+        }
+        continue;
+      }
+      if(byte == 0x1B) {
+        inputEscapeState = EscapeState::ESCAPE_STARTED;
+        continue;
+      }
+      if(inputEscapeState == EscapeState::ESCAPE_STARTED) {
+        inputEscapeState = EscapeState::NO_ESCAPE;
+        if(byte == '[' || byte == 'O') {
+          inputEscapeState = EscapeState::IN_SEQUENCE;
+          continue;
+        }
+      }
+
+      int key = std::toupper(byte);
+      for(int k = 0; k < 16; k++) {
+        if(keyMap[k] != key) {
+          continue;
+        }
+
+        keyLastSeen[k] = now;
+        if(!Chip8.keypadState[k]) {
+          keyEvent(k, true);
+        }
+      }
+    }
+  }
+
+  for(int k = 0; k < 16; k++) {
+    if(Chip8.keypadState[k] && now - keyLastSeen[k] > keyHoldDuration) {
+      keyEvent(k, false);
+    }
+  }
+}
+
+int main() {
+  // Step 1: Read configuration.
+  try {
+    config = loadConfig();
+  }
+  catch(...) {
+    std::cout << "Error parsing config.json" << std::endl;
+    return -1;
+  }
+
+  try {
+    int i = 0;
+    for(auto& entry : config["controls"].items()) {
+      keyMap[i] = std::toupper((int)((std::string)(entry.value())).c_str()[0]);
+      i++;
+    }
+  }
+  catch(...) {
+    std::cout << "Error getting control keybinds. Entry may have been added or removed from config.json" << std:: endl;
+    return -1;
+  }
+
+  // Every setting is read before the terminal is switched to raw mode, so bad values can't leave it unusable.
+  TerminalGlyphs glyphs = TerminalGlyphs::HALF_BLOCK;
+  bool trueColor = true;
+  int palette[4][3] = {{0, 0, 0}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}};
+  Variant variant = Variant::CHIP_8;
+  std::string romFileName;
+  int cpuCyclesPerFrame = 0;
+  try {
+    if(config.contains("terminal")) {
+      glyphs = (config["terminal"].value("glyphs", "halfBlock") == "braille") ? TerminalGlyphs::BRAILLE : TerminalGlyphs::HALF_BLOCK;
+      trueColor = config["terminal"].value("trueColor", true);
+      keyHoldDuration = std::chrono::milliseconds(config["terminal"].value("keyHoldMilliseconds", 700));
+    }
+    readConfigPalette(config, palette);
+    variant = parseVariant(config["general"].value("variant", "CHIP-8"));
+    romFileName = config["general"]["romFileName"];
+    cpuCyclesPerFrame = config["general"]["cpuCyclesPerFrame"];
+  }
+  catch(...) {
+    std::cout << "Error reading settings. Entry may be missing from config.json or have the wrong type" << std::endl;
+    return -1;
+  }
+
+  TerminalRenderer renderer(glyphs, trueColor);
+  for(int i = 0; i < 4; i++) {
+    renderer.setPaletteColor(i, palette[i][0], palette[i][1], palette[i][2]);
+  }
+
+  // Step 2: Initialize Chip8 and load program.
+  Chip8.initialization(variant);
+  std::fill_n(Chip8.keypadState, 16, 0);
+
+  int programLoaded = Chip8.loadProgram(romFileName);
+  if(programLoaded != 0) {
+    std::cout << "Error Accessing ROM" << std::endl;
+    return -1;
+  }
+
+  // Step 3: Set up the terminal.
+  if(enableRawInput() != 0) {
+    std::cout << "Couldn't switch terminal to raw input mode, stdin must be a terminal." << std::endl;
+    return -1;
+  }
+  std::signal(SIGINT, signalHandler);
+  std::signal(SIGTERM, signalHandler);
+  std::signal(SIGWINCH, resizeHandler);
+  renderer.begin();
+
+  // Step 4: Loop CPU cycles. The terminal is restored even if emulation stops with an exception.
+  bool emulationFailed = false;
+  try {
+    while(!quitRequested) {
+      auto startTime = std::chrono::steady_clock::now();
+      pollInput();
+
+      if(terminalResized) {
+        terminalResized = 0;
+        renderer.updateTerminalSize();
+      }
+      renderer.draw(Chip8);
+
+      if(currentHaltState == HaltState::NOT_HALTING) {
+        for(int i = 0; i < cpuCyclesPerFrame; i++) {
+          currentHaltState = (HaltState)Chip8.CPUCycle();
+
+          if(currentHaltState != HaltState::NOT_HALTING) {
+            break;
+          }
+
+          // Rings the bell when a sound starts playing.
+          unsigned short ranOpcode = Chip8.getLastExecutedOpcode();
+          bool soundTimerSet = ((ranOpcode & 0xF0FF) == 0xF018);
+          if(soundTimerSet && Chip8.soundTimer != 0) {
+            renderer.bell();
+          }
+        }
+      }
+
+      if(Chip8.delayTimer > 0) {
+        Chip8.delayTimer--;
+      }
+
+      if(Chip8.soundTimer > 0) {
+        Chip8.soundTimer--;
+      }
+
+      std::this_thread::sleep_until(startTime + frameDuration);
+    }
+  }
+  catch(...) {
+    emulationFailed = true;
+  }
+
+  renderer.end();
+  restoreInput();
+
+  if(emulationFailed) {
+    std::cout << "Emulation stopped because of an unexpected error" << std::endl;
+    return -1;
+  }
+  return 0;
+}